@@ -0,0 +1,334 @@
+#ifndef MULTITHREADEDOBSERVER_ADAPTIVESHAREDMUTEX_H
+#define MULTITHREADEDOBSERVER_ADAPTIVESHAREDMUTEX_H
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <condition_variable>
+
+namespace observer
+{
+    using std::atomic;
+    using std::mutex;
+    using std::condition_variable;
+    using std::cv_status;
+    using std::lock_guard;
+    using std::unique_lock;
+    using std::chrono::duration;
+    using std::chrono::time_point;
+    using std::chrono::steady_clock;
+    using std::chrono::nanoseconds;
+    using std::chrono::duration_cast;
+    using std::memory_order_relaxed;
+    using std::memory_order_acquire;
+    using std::memory_order_seq_cst;
+    using std::atomic_thread_fence;
+
+    struct LockStatistics
+    {
+        uint64_t shared_acquisitions;
+        uint64_t exclusive_acquisitions;
+        uint64_t contended_acquisitions;
+        uint64_t parked_acquisitions;
+        uint64_t timeouts;
+        uint64_t wait_ns;
+        uint64_t exclusive_hold_ns;
+        uint64_t max_exclusive_hold_ns;
+    };
+
+    // Reader/writer lock for short critical sections. Uncontended acquisition is a single CAS; a
+    // contended one spins for an adaptively estimated number of rounds, then parks on a condition
+    // variable. Waiting writers block new readers, so a steady stream of notifiers cannot starve
+    // Add/Remove. Satisfies TimedLockable and SharedTimedLockable, so unique_lock and shared_lock
+    // work with it unchanged.
+    //
+    // Statistics are sampled on the slow path only. Defining MULTITHREADEDOBSERVER_LOCK_STATISTICS
+    // also counts uncontended acquisitions and times exclusive holds, at the cost of an extra RMW per
+    // acquisition and two clock reads per exclusive section; otherwise those fields stay zero.
+    class AdaptiveSharedMutex
+    {
+    public:
+        AdaptiveSharedMutex() = default;
+        AdaptiveSharedMutex(const AdaptiveSharedMutex&) = delete;
+        AdaptiveSharedMutex& operator=(const AdaptiveSharedMutex&) = delete;
+
+        void lock() noexcept;
+        bool try_lock() noexcept;
+        template<typename _Rep, typename _Period>
+        bool try_lock_for(const duration<_Rep, _Period>&) noexcept;
+        template<typename _Clock, typename _Duration>
+        bool try_lock_until(const time_point<_Clock, _Duration>&) noexcept;
+        void unlock() noexcept;
+
+        void lock_shared() noexcept;
+        bool try_lock_shared() noexcept;
+        template<typename _Rep, typename _Period>
+        bool try_lock_shared_for(const duration<_Rep, _Period>&) noexcept;
+        template<typename _Clock, typename _Duration>
+        bool try_lock_shared_until(const time_point<_Clock, _Duration>&) noexcept;
+        void unlock_shared() noexcept;
+
+        LockStatistics Statistics() const noexcept;
+
+    private:
+        static constexpr uint32_t kWriter = 1u << 31;
+        static constexpr uint32_t kWaitingWriter = 1u << 16;
+        static constexpr uint32_t kWaitingWriterMask = 0x7fffu << 16;
+        static constexpr uint32_t kReaderMask = 0xffffu;
+        static constexpr int32_t kMaxSpins = 100;
+
+        bool TryAcquireWaitingExclusive() noexcept;
+        bool LockExclusive(bool timed, steady_clock::time_point deadline) noexcept;
+        bool LockShared(bool timed, steady_clock::time_point deadline) noexcept;
+        template<typename TryAcquire>
+        bool SpinThenPark(TryAcquire, bool timed, steady_clock::time_point deadline) noexcept;
+        void WakeParked() noexcept;
+        void ExclusiveAcquired() noexcept;
+
+        static void CpuRelax() noexcept;
+        static uint64_t Now() noexcept;
+
+        // Touched by every acquisition; kept apart from the counters below.
+        alignas(64) atomic<uint32_t> state_{0};
+        atomic<uint32_t> parked_{0};
+        mutex park_mu_;
+        condition_variable park_cv_;
+
+        alignas(64) atomic<int32_t> spin_estimate_{0};
+        // Written only by the exclusive owner.
+        uint64_t exclusive_since_ = 0;
+
+        atomic<uint64_t> shared_acquisitions_{0};
+        atomic<uint64_t> exclusive_acquisitions_{0};
+        atomic<uint64_t> contended_acquisitions_{0};
+        atomic<uint64_t> parked_acquisitions_{0};
+        atomic<uint64_t> timeouts_{0};
+        atomic<uint64_t> wait_ns_{0};
+        atomic<uint64_t> exclusive_hold_ns_{0};
+        atomic<uint64_t> max_exclusive_hold_ns_{0};
+    };
+
+
+    inline void AdaptiveSharedMutex::lock() noexcept
+    {
+        if (!try_lock()) LockExclusive(false, steady_clock::time_point{});
+    }
+
+    inline bool AdaptiveSharedMutex::try_lock() noexcept
+    {
+        uint32_t state = state_.load(memory_order_relaxed);
+        if ((state & (kWriter | kReaderMask)) != 0) return false;
+        if (!state_.compare_exchange_strong(state, state | kWriter, memory_order_acquire, memory_order_relaxed))
+            return false;
+
+        ExclusiveAcquired();
+        return true;
+    }
+
+    template<typename _Rep, typename _Period>
+    bool AdaptiveSharedMutex::try_lock_for(const duration<_Rep, _Period>& timeout) noexcept
+    {
+        if (try_lock()) return true;
+        return LockExclusive(true, steady_clock::now() + duration_cast<steady_clock::duration>(timeout));
+    }
+
+    template<typename _Clock, typename _Duration>
+    bool AdaptiveSharedMutex::try_lock_until(const time_point<_Clock, _Duration>& deadline) noexcept
+    {
+        return try_lock_for(deadline - _Clock::now());
+    }
+
+    inline void AdaptiveSharedMutex::unlock() noexcept
+    {
+#ifdef MULTITHREADEDOBSERVER_LOCK_STATISTICS
+        uint64_t held = Now() - exclusive_since_;
+        exclusive_hold_ns_.fetch_add(held, memory_order_relaxed);
+        if (held > max_exclusive_hold_ns_.load(memory_order_relaxed))
+            max_exclusive_hold_ns_.store(held, memory_order_relaxed);
+#endif
+
+        state_.fetch_sub(kWriter, memory_order_seq_cst);
+        if (parked_.load(memory_order_seq_cst) > 0) WakeParked();
+    }
+
+    inline void AdaptiveSharedMutex::lock_shared() noexcept
+    {
+        if (!try_lock_shared()) LockShared(false, steady_clock::time_point{});
+    }
+
+    inline bool AdaptiveSharedMutex::try_lock_shared() noexcept
+    {
+        uint32_t state = state_.load(memory_order_relaxed);
+        while ((state & (kWriter | kWaitingWriterMask)) == 0)
+        {
+            if (state_.compare_exchange_weak(state, state + 1, memory_order_acquire, memory_order_relaxed))
+            {
+#ifdef MULTITHREADEDOBSERVER_LOCK_STATISTICS
+                shared_acquisitions_.fetch_add(1, memory_order_relaxed);
+#endif
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    template<typename _Rep, typename _Period>
+    bool AdaptiveSharedMutex::try_lock_shared_for(const duration<_Rep, _Period>& timeout) noexcept
+    {
+        if (try_lock_shared()) return true;
+        return LockShared(true, steady_clock::now() + duration_cast<steady_clock::duration>(timeout));
+    }
+
+    template<typename _Clock, typename _Duration>
+    bool AdaptiveSharedMutex::try_lock_shared_until(const time_point<_Clock, _Duration>& deadline) noexcept
+    {
+        return try_lock_shared_for(deadline - _Clock::now());
+    }
+
+    inline void AdaptiveSharedMutex::unlock_shared() noexcept
+    {
+        uint32_t state = state_.fetch_sub(1, memory_order_seq_cst);
+        // Only the last reader out can let a writer in.
+        if ((state & kReaderMask) == 1 && parked_.load(memory_order_seq_cst) > 0) WakeParked();
+    }
+
+    inline LockStatistics AdaptiveSharedMutex::Statistics() const noexcept
+    {
+        return LockStatistics{shared_acquisitions_.load(memory_order_relaxed),
+                              exclusive_acquisitions_.load(memory_order_relaxed),
+                              contended_acquisitions_.load(memory_order_relaxed),
+                              parked_acquisitions_.load(memory_order_relaxed),
+                              timeouts_.load(memory_order_relaxed),
+                              wait_ns_.load(memory_order_relaxed),
+                              exclusive_hold_ns_.load(memory_order_relaxed),
+                              max_exclusive_hold_ns_.load(memory_order_relaxed)};
+    }
+
+    inline bool AdaptiveSharedMutex::TryAcquireWaitingExclusive() noexcept
+    {
+        uint32_t state = state_.load(memory_order_relaxed);
+        while ((state & (kWriter | kReaderMask)) == 0)
+        {
+            if (state_.compare_exchange_weak(state, (state - kWaitingWriter) | kWriter,
+                                             memory_order_acquire, memory_order_relaxed))
+                return true;
+        }
+
+        return false;
+    }
+
+    inline bool AdaptiveSharedMutex::LockExclusive(bool timed, steady_clock::time_point deadline) noexcept
+    {
+        uint64_t started = Now();
+        contended_acquisitions_.fetch_add(1, memory_order_relaxed);
+
+        state_.fetch_add(kWaitingWriter, memory_order_seq_cst);
+        bool acquired = SpinThenPark([this]() { return TryAcquireWaitingExclusive(); }, timed, deadline);
+        wait_ns_.fetch_add(Now() - started, memory_order_relaxed);
+
+        if (acquired)
+        {
+            ExclusiveAcquired();
+            return true;
+        }
+
+        // Readers may be parked behind our waiting bit.
+        state_.fetch_sub(kWaitingWriter, memory_order_seq_cst);
+        if (parked_.load(memory_order_seq_cst) > 0) WakeParked();
+        timeouts_.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+
+    inline bool AdaptiveSharedMutex::LockShared(bool timed, steady_clock::time_point deadline) noexcept
+    {
+        uint64_t started = Now();
+        contended_acquisitions_.fetch_add(1, memory_order_relaxed);
+
+        bool acquired = SpinThenPark([this]() { return try_lock_shared(); }, timed, deadline);
+        wait_ns_.fetch_add(Now() - started, memory_order_relaxed);
+
+        if (!acquired) timeouts_.fetch_add(1, memory_order_relaxed);
+        return acquired;
+    }
+
+    template<typename TryAcquire>
+    bool AdaptiveSharedMutex::SpinThenPark(TryAcquire try_acquire, bool timed, steady_clock::time_point deadline) noexcept
+    {
+        // Spin budget follows the spins that recently paid off, like glibc's adaptive mutex.
+        int32_t estimate = spin_estimate_.load(memory_order_relaxed);
+        int32_t limit = estimate * 2 + 10;
+        if (limit > kMaxSpins) limit = kMaxSpins;
+        for (int32_t spins = 0; spins < limit; ++spins)
+        {
+            if (try_acquire())
+            {
+                spin_estimate_.store(estimate + (spins - estimate) / 8, memory_order_relaxed);
+                return true;
+            }
+            CpuRelax();
+        }
+        spin_estimate_.store(estimate + (limit - estimate) / 8, memory_order_relaxed);
+
+        parked_acquisitions_.fetch_add(1, memory_order_relaxed);
+        unique_lock<mutex> lock(park_mu_);
+        parked_.fetch_add(1, memory_order_seq_cst);
+        // Pairs with the releaser's state_ RMW followed by its parked_ load: either it sees us
+        // registered, or our re-check below sees the lock released.
+        atomic_thread_fence(memory_order_seq_cst);
+
+        bool acquired = true;
+        while (!try_acquire())
+        {
+            if (!timed)
+            {
+                park_cv_.wait(lock);
+            }
+            else if (park_cv_.wait_until(lock, deadline) == cv_status::timeout)
+            {
+                acquired = try_acquire();
+                break;
+            }
+        }
+
+        parked_.fetch_sub(1, memory_order_seq_cst);
+        return acquired;
+    }
+
+    inline void AdaptiveSharedMutex::WakeParked() noexcept
+    {
+        // Taking park_mu_ orders us after any waiter that has registered but not yet started waiting.
+        {
+            lock_guard<mutex> lock(park_mu_);
+        }
+        park_cv_.notify_all();
+    }
+
+    inline void AdaptiveSharedMutex::ExclusiveAcquired() noexcept
+    {
+#ifdef MULTITHREADEDOBSERVER_LOCK_STATISTICS
+        exclusive_acquisitions_.fetch_add(1, memory_order_relaxed);
+        exclusive_since_ = Now();
+#endif
+    }
+
+    inline void AdaptiveSharedMutex::CpuRelax() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    inline uint64_t AdaptiveSharedMutex::Now() noexcept
+    {
+        return static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+#endif //MULTITHREADEDOBSERVER_ADAPTIVESHAREDMUTEX_H
@@ -0,0 +1,178 @@
+#ifndef MULTITHREADEDOBSERVER_EVENTLOOP_H
+#define MULTITHREADEDOBSERVER_EVENTLOOP_H
+
+#include <new>
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <functional>
+
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+namespace observer
+{
+    using std::atomic;
+    using std::function;
+    using std::shared_ptr;
+    using std::memory_order_relaxed;
+    using std::memory_order_acquire;
+    using std::memory_order_release;
+    using std::memory_order_acq_rel;
+
+    // Delivery queue owned by a single-threaded reactor. Any thread may Post(); only the owning
+    // thread calls Dispatch(), after Fd() became readable in its epoll set. Wakeups are coalesced:
+    // the eventfd is written once per batch, not once per task.
+    class EventLoop
+    {
+    public:
+        using Task = function<void()>;
+
+        static shared_ptr<EventLoop> Create() noexcept;
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+        ~EventLoop();
+
+        int Fd() const noexcept;
+        bool Post(Task task) noexcept;
+        size_t Dispatch() noexcept;
+
+    private:
+        struct Node
+        {
+            atomic<Node*> next{nullptr};
+            Task task;
+        };
+
+        explicit EventLoop(int fd) noexcept;
+
+        void Push(Node* node) noexcept;
+        Node* Pop() noexcept;
+
+        int fd_;
+        atomic<bool> wakeup_pending_{false};
+        atomic<Node*> head_;
+        Node* tail_;
+        Node stub_;
+    };
+
+    inline shared_ptr<EventLoop> EventLoop::Create() noexcept
+    {
+        int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0) return nullptr;
+
+        EventLoop* loop = new (std::nothrow) EventLoop(fd);
+        if (loop == nullptr)
+        {
+            ::close(fd);
+            return nullptr;
+        }
+
+        // On a failed control block allocation shared_ptr deletes the loop, which closes the fd.
+        try
+        {
+            return shared_ptr<EventLoop>(loop);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    inline EventLoop::EventLoop(int fd) noexcept
+            : fd_(fd), head_(&stub_), tail_(&stub_)
+    {
+    }
+
+    inline EventLoop::~EventLoop()
+    {
+        while (Node* node = Pop()) delete node;
+        ::close(fd_);
+    }
+
+    inline int EventLoop::Fd() const noexcept
+    {
+        return fd_;
+    }
+
+    inline bool EventLoop::Post(Task task) noexcept
+    {
+        Node* node = new (std::nothrow) Node;
+        if (node == nullptr) return false;
+        node->task = std::move(task);
+        Push(node);
+
+        // Only the producer that flips the flag pays for the syscall; the rest ride on its wakeup.
+        if (!wakeup_pending_.exchange(true, memory_order_acq_rel))
+        {
+            uint64_t one = 1;
+            while (::write(fd_, &one, sizeof(one)) < 0 && errno == EINTR);
+        }
+
+        return true;
+    }
+
+    inline size_t EventLoop::Dispatch() noexcept
+    {
+        uint64_t counter;
+        while (::read(fd_, &counter, sizeof(counter)) < 0 && errno == EINTR);
+
+        // Re-arm before draining, so a task pushed after this point is guaranteed a fresh wakeup.
+        wakeup_pending_.exchange(false, memory_order_acq_rel);
+
+        size_t handled = 0;
+        while (Node* node = Pop())
+        {
+            node->task();
+            delete node;
+            ++handled;
+        }
+
+        return handled;
+    }
+
+    inline void EventLoop::Push(Node* node) noexcept
+    {
+        node->next.store(nullptr, memory_order_relaxed);
+        Node* prev = head_.exchange(node, memory_order_acq_rel);
+        prev->next.store(node, memory_order_release);
+    }
+
+    inline EventLoop::Node* EventLoop::Pop() noexcept
+    {
+        Node* tail = tail_;
+        Node* next = tail->next.load(memory_order_acquire);
+        if (tail == &stub_)
+        {
+            if (next == nullptr) return nullptr;
+            tail_ = next;
+            tail = next;
+            next = next->next.load(memory_order_acquire);
+        }
+
+        if (next != nullptr)
+        {
+            tail_ = next;
+            return tail;
+        }
+
+        // A producer is between its exchange and link; its own Post() will wake us again.
+        if (tail != head_.load(memory_order_acquire)) return nullptr;
+
+        Push(&stub_);
+        next = tail->next.load(memory_order_acquire);
+        if (next != nullptr)
+        {
+            tail_ = next;
+            return tail;
+        }
+
+        return nullptr;
+    }
+}
+
+#endif //MULTITHREADEDOBSERVER_EVENTLOOP_H
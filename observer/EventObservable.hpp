@@ -0,0 +1,288 @@
+#ifndef MULTITHREADEDOBSERVER_EVENTOBSERVABLE_H
+#define MULTITHREADEDOBSERVER_EVENTOBSERVABLE_H
+
+#include <tuple>
+#include <mutex>
+#include <memory>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+#include "Trait.hpp"
+#include "Observable.hpp"
+
+namespace observer
+{
+    using std::tuple;
+    using std::vector;
+    using std::integral_constant;
+    using std::get;
+    using std::size_t;
+    using std::decay_t;
+
+    // Subject for a fixed list of event types. Every event type owns its own subscriber list, and an
+    // observer is put only into the lists it has a HandleEvent(const Event&) or HandleEvent(Event)
+    // overload for, so a notification never visits observers that cannot take it. Observers of
+    // different types may be mixed; they are identified by ownership, so no Hash() is needed.
+    template<typename... Events>
+    class EventObservable
+    {
+        template<typename Event>
+        struct Handler
+        {
+            using EventType = Event;
+
+            weak_ptr<void> observer;
+            void (*handle)(void*, const Event&);
+        };
+
+        template<typename Event>
+        using HandlerList = vector<Handler<Event>>;
+        using Registry = tuple<HandlerList<Events>...>;
+        using CountType = size_t;
+
+    public:
+        template<typename Observer, typename _Rep, typename _Period>
+        static AddStatus TryAddObserver(weak_ptr<Observer>, duration<_Rep, _Period>) noexcept;
+        template<typename Observer, typename _Rep, typename _Period>
+        static RemoveStatus TryRemoveObserver(weak_ptr<Observer>, duration<_Rep, _Period>) noexcept;
+        template<typename Event, typename _Rep, typename _Period>
+        static void TryNotifyObservers(duration<_Rep, _Period>, const Event&) noexcept;
+
+        template<typename Observer>
+        static AddStatus AddObserverLocked(weak_ptr<Observer>) noexcept;
+        template<typename Observer>
+        static RemoveStatus RemoveObserverLocked(weak_ptr<Observer>) noexcept;
+        static RemoveStatus RemoveAllLocked() noexcept;
+        static RemoveStatus RemoveExpiredLocked() noexcept;
+        template<typename Event>
+        static void NotifyObserversLocked(const Event&) noexcept;
+
+        template<typename Event>
+        static CountType ObserversCount() noexcept;
+
+    private:
+        template<typename Observer>
+        static AddStatus Insert(const weak_ptr<Observer>&) noexcept;
+        template<typename Observer>
+        static RemoveStatus Erase(const weak_ptr<Observer>&) noexcept;
+        template<typename Event>
+        static void Fanout(const Event&) noexcept;
+
+        template<typename Observer, typename Event>
+        static void Handle(void* observer, const Event& event) noexcept;
+        template<typename Observer, typename Event>
+        static void InsertInto(HandlerList<Event>&, const weak_ptr<Observer>&, true_type) noexcept;
+        template<typename Observer, typename Event>
+        static void InsertInto(HandlerList<Event>&, const weak_ptr<Observer>&, false_type) noexcept;
+        template<typename Functional>
+        static void ForEachList(Functional) noexcept;
+
+        static Registry observers_;
+        static timed_mutex observers_mu_;
+    };
+
+    template<typename... Events>
+    typename EventObservable<Events...>::Registry EventObservable<Events...>::observers_;
+
+    template<typename... Events>
+    timed_mutex EventObservable<Events...>::observers_mu_;
+
+
+    template<typename... Events>
+    template<typename Observer, typename _Rep, typename _Period>
+    AddStatus
+    EventObservable<Events...>::TryAddObserver(weak_ptr<Observer> observer, duration<_Rep, _Period> timeout) noexcept
+    {
+        if (observer.expired()) return AddStatus::InvalidPtr;
+
+        unique_lock<timed_mutex> lock(observers_mu_, defer_lock);
+        if (!lock.try_lock_for(timeout)) return AddStatus::Timeout;
+
+        return Insert(observer);
+    }
+
+    template<typename... Events>
+    template<typename Observer, typename _Rep, typename _Period>
+    RemoveStatus
+    EventObservable<Events...>::TryRemoveObserver(weak_ptr<Observer> observer, duration<_Rep, _Period> timeout) noexcept
+    {
+        if (observer.expired()) return RemoveStatus::InvalidPtr;
+
+        unique_lock<timed_mutex> lock(observers_mu_, defer_lock);
+        if (!lock.try_lock_for(timeout)) return RemoveStatus::Timeout;
+
+        return Erase(observer);
+    }
+
+    template<typename... Events>
+    template<typename Event, typename _Rep, typename _Period>
+    void
+    EventObservable<Events...>::TryNotifyObservers(duration<_Rep, _Period> timeout, const Event& event) noexcept
+    {
+        static_assert(is_one_of<Event, Events...>::value, "Event is not published by this EventObservable");
+
+        unique_lock<timed_mutex> lock(observers_mu_, defer_lock);
+        if (lock.try_lock_for(timeout))
+            Fanout(event);
+    }
+
+    template<typename... Events>
+    template<typename Observer>
+    AddStatus
+    EventObservable<Events...>::AddObserverLocked(weak_ptr<Observer> observer) noexcept
+    {
+        if (observer.expired()) return AddStatus::InvalidPtr;
+
+        lock_guard<timed_mutex> lock(observers_mu_);
+        return Insert(observer);
+    }
+
+    template<typename... Events>
+    template<typename Observer>
+    RemoveStatus
+    EventObservable<Events...>::RemoveObserverLocked(weak_ptr<Observer> observer) noexcept
+    {
+        if (observer.expired()) return RemoveStatus::InvalidPtr;
+
+        lock_guard<timed_mutex> lock(observers_mu_);
+        return Erase(observer);
+    }
+
+    template<typename... Events>
+    RemoveStatus
+    EventObservable<Events...>::RemoveAllLocked() noexcept
+    {
+        lock_guard<timed_mutex> lock(observers_mu_);
+        ForEachList([](auto& handlers) { handlers.clear(); });
+
+        return RemoveStatus::Success;
+    }
+
+    template<typename... Events>
+    RemoveStatus
+    EventObservable<Events...>::RemoveExpiredLocked() noexcept
+    {
+        lock_guard<timed_mutex> lock(observers_mu_);
+        ForEachList([](auto& handlers) {
+            handlers.erase(remove_if(handlers.begin(), handlers.end(),
+                                     [](const auto& handler) { return handler.observer.expired(); }),
+                           handlers.end());
+        });
+
+        return RemoveStatus::Success;
+    }
+
+    template<typename... Events>
+    template<typename Event>
+    void
+    EventObservable<Events...>::NotifyObserversLocked(const Event& event) noexcept
+    {
+        static_assert(is_one_of<Event, Events...>::value, "Event is not published by this EventObservable");
+
+        lock_guard<timed_mutex> lock(observers_mu_);
+        Fanout(event);
+    }
+
+    template<typename... Events>
+    template<typename Event>
+    typename EventObservable<Events...>::CountType
+    EventObservable<Events...>::ObserversCount() noexcept
+    {
+        static_assert(is_one_of<Event, Events...>::value, "Event is not published by this EventObservable");
+
+        return get<HandlerList<Event>>(observers_).size();
+    }
+
+    template<typename... Events>
+    template<typename Observer>
+    AddStatus
+    EventObservable<Events...>::Insert(const weak_ptr<Observer>& observer) noexcept
+    {
+        static_assert(is_one_of<true_type, typename integral_constant<bool, handles_event<Observer, Events>::value>::type...>::value,
+                      "Observer handles none of the events of this EventObservable");
+
+        bool added = false;
+        ForEachList([&observer, &added](const auto& handlers) {
+            added = added || find_if(handlers.begin(), handlers.end(), [&observer](const auto& handler) {
+                return !handler.observer.owner_before(observer) && !observer.owner_before(handler.observer);
+            }) != handlers.end();
+        });
+        if (added) return AddStatus::AlreadyAdded;
+
+        ForEachList([&observer](auto& handlers) {
+            using Event = typename decay_t<decltype(handlers)>::value_type::EventType;
+            InsertInto(handlers, observer, integral_constant<bool, handles_event<Observer, Event>::value>{});
+        });
+
+        return AddStatus::Success;
+    }
+
+    template<typename... Events>
+    template<typename Observer>
+    RemoveStatus
+    EventObservable<Events...>::Erase(const weak_ptr<Observer>& observer) noexcept
+    {
+        bool removed = false;
+        ForEachList([&observer, &removed](auto& handlers) {
+            auto it = find_if(handlers.begin(), handlers.end(), [&observer](const auto& handler) {
+                return !handler.observer.owner_before(observer) && !observer.owner_before(handler.observer);
+            });
+            if (it == handlers.end()) return;
+
+            handlers.erase(it);
+            removed = true;
+        });
+
+        return removed ? RemoveStatus::Success : RemoveStatus::NotFound;
+    }
+
+    template<typename... Events>
+    template<typename Event>
+    void
+    EventObservable<Events...>::Fanout(const Event& event) noexcept
+    {
+        for (const auto& handler: get<HandlerList<Event>>(observers_))
+        {
+            if (auto observer = handler.observer.lock())
+                handler.handle(observer.get(), event);
+        }
+    }
+
+    template<typename... Events>
+    template<typename Observer, typename Event>
+    void
+    EventObservable<Events...>::Handle(void* observer, const Event& event) noexcept
+    {
+        static_cast<Observer*>(observer)->HandleEvent(event);
+    }
+
+    template<typename... Events>
+    template<typename Observer, typename Event>
+    void
+    EventObservable<Events...>::InsertInto(HandlerList<Event>& handlers, const weak_ptr<Observer>& observer,
+                                           true_type) noexcept
+    {
+        handlers.push_back(Handler<Event>{observer, &Handle<Observer, Event>});
+    }
+
+    template<typename... Events>
+    template<typename Observer, typename Event>
+    void
+    EventObservable<Events...>::InsertInto(HandlerList<Event>&, const weak_ptr<Observer>&, false_type) noexcept
+    {
+    }
+
+    template<typename... Events>
+    template<typename Functional>
+    void
+    EventObservable<Events...>::ForEachList(Functional functional) noexcept
+    {
+        int expand[] = {0, (functional(get<HandlerList<Events>>(observers_)), 0)...};
+        (void)expand;
+    }
+}
+
+#endif //MULTITHREADEDOBSERVER_EVENTOBSERVABLE_H
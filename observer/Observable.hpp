@@ -1,15 +1,22 @@
 #ifndef MULTITHREADEDOBSERVER_OBSERVABLE_H
 #define MULTITHREADEDOBSERVER_OBSERVABLE_H
 
+#include <tuple>
 #include <thread>
 #include <mutex>
 #include <memory>
 #include <chrono>
 #include <future>
+#include <vector>
+#include <cstdint>
+#include <utility>
 #include <algorithm>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "Trait.hpp"
+#include "EventLoop.hpp"
+#include "AdaptiveSharedMutex.hpp"
 
 namespace observer
 {
@@ -17,6 +24,7 @@ namespace observer
     using ObserverTrait = typename std::enable_if<is_observer<Observer>::value>::type;
 
     using std::unordered_map;
+    using std::vector;
     using std::shared_ptr;
     using std::weak_ptr;
     using std::timed_mutex;
@@ -28,11 +36,18 @@ namespace observer
 
     using std::lock_guard;
     using std::unique_lock;
+    using std::shared_lock;
     using std::find_if;
     using std::remove_if;
     using std::forward;
     using std::async;
     using std::result_of;
+    using std::tuple;
+    using std::decay_t;
+    using std::index_sequence;
+    using std::index_sequence_for;
+    using std::integral_constant;
+    using std::is_copy_constructible;
 
     enum class AddStatus { Success, Timeout, AlreadyAdded, InvalidPtr };
     enum class RemoveStatus { Success, Timeout, NotFound, InvalidPtr };
@@ -59,12 +74,32 @@ namespace observer
         using HashType = typename result_of<decltype(&Observer::Hash)(Observer)>::type;
         using ObserverShared = shared_ptr<Observer>;
         using ObserverWeak = weak_ptr<Observer>;
-        using CountType = typename unordered_map<HashType, ObserverWeak>::size_type;
+        using LoopWeak = weak_ptr<EventLoop>;
+
+        struct Subscription
+        {
+            ObserverWeak observer;
+            LoopWeak loop;
+            bool bound = false;
+        };
+
+        using CountType = typename unordered_map<HashType, Subscription>::size_type;
+
+        enum class MutationKind { Add, Remove, RemoveAll, RemoveExpired };
+
+        struct Mutation
+        {
+            MutationKind kind;
+            HashType hash;
+            Subscription subscription;
+        };
 
     public:
         template<typename _Rep, typename _Period>
         static AddStatus TryAddObserver(ObserverWeak, duration<_Rep, _Period>) noexcept;
         template<typename _Rep, typename _Period>
+        static AddStatus TryAddObserver(ObserverWeak, LoopWeak, duration<_Rep, _Period>) noexcept;
+        template<typename _Rep, typename _Period>
         static RemoveStatus TryRemoveObserver(ObserverWeak, duration<_Rep, _Period>) noexcept;
         template<typename _Rep, typename _Period>
         static RemoveStatus TryRemoveObserver(HashType, duration<_Rep, _Period>) noexcept;
@@ -76,32 +111,80 @@ namespace observer
         static void TryNotifyObservers(duration<_Rep, _Period>, NotifyArguments&&...) noexcept;
 
         static AddStatus AddObserverLocked(ObserverWeak) noexcept;
+        // A loop-bound observer handles copies of the arguments on the loop's Dispatch(); events with
+        // arguments that cannot be copied are not delivered to it.
+        static AddStatus AddObserverLocked(ObserverWeak, LoopWeak) noexcept;
         static RemoveStatus RemoveObserverLocked(ObserverWeak) noexcept;
         static RemoveStatus RemoveObserverLocked(HashType) noexcept;
         static RemoveStatus RemoveAllLocked() noexcept;
         static RemoveStatus RemoveExpiredLocked() noexcept;
+        // Notifiers share the registry lock, so HandleEvent may run on several threads at once, also
+        // for the same observer; an observer notified from more than one thread guards its own state.
         template<typename... NotifyArguments>
         static void NotifyObserversLocked(NotifyArguments&&...) noexcept;
 
         template<typename... NotifyArguments>
         static void AsyncNotifyObservers(NotifyArguments&&... args) noexcept;
+        // The callback runs once every unbound observer has handled the event; loop-bound observers
+        // have by then only had it queued on their loop, and handle it on their next Dispatch().
         template<typename Functional, typename... NotifyArguments>
         static void AsyncNotifyObserversCallback(Functional callback, NotifyArguments&&... args) noexcept;
 
         static CountType ObserversCount() noexcept;
+        static LockStatistics LockStats() noexcept;
 
     private:
-        static unordered_map<HashType, ObserverWeak> observers_;
-        static timed_mutex obervers_mu_;
+        template<typename... NotifyArguments>
+        static void Fanout(NotifyArguments&&...) noexcept;
+        template<typename... NotifyArguments>
+        static void Deliver(const Subscription&, NotifyArguments&&...) noexcept;
+        template<typename... NotifyArguments>
+        static void Queue(const Subscription&, true_type, NotifyArguments&&...) noexcept;
+        template<typename... NotifyArguments>
+        static void Queue(const Subscription&, false_type, NotifyArguments&&...) noexcept;
+        template<typename Arguments, size_t... Indices>
+        static void HandleQueued(Observer&, Arguments&, index_sequence<Indices...>) noexcept;
+        static bool Registered(const HashType&) noexcept;
+        static bool Deferred(Mutation) noexcept;
+        static void ApplyDeferred() noexcept;
+        template<typename _Rep, typename _Period>
+        static void TryApplyDeferred(duration<_Rep, _Period>) noexcept;
+        static void ApplyDeferredExclusive() noexcept;
+
+        static unordered_map<HashType, Subscription> observers_;
+        static AdaptiveSharedMutex obervers_mu_;
+
+        // Registry changes requested from inside HandleEvent while this thread is fanning out
+        // (and therefore already holds obervers_mu_ shared) are logged here and applied under the
+        // exclusive lock once the fan-out finishes. Several notifiers may log at the same time.
+        // Every exclusive section drains the log before its own change, so a logged change never
+        // lands after a direct one that was made later.
+        static vector<Mutation> deferred_;
+        static mutex deferred_mu_;
+        static atomic<bool> deferred_pending_;
+        static thread_local uint32_t dispatch_depth_;
     };
 
     template<typename Observer>
     unordered_map<typename Observable<Observer, ObserverTrait<Observer>>::HashType,
-                  typename Observable<Observer, ObserverTrait<Observer>>::ObserverWeak>
+                  typename Observable<Observer, ObserverTrait<Observer>>::Subscription>
             Observable<Observer, ObserverTrait<Observer>>::observers_;
 
     template<typename Observer>
-    timed_mutex Observable<Observer, ObserverTrait<Observer>>::obervers_mu_;
+    AdaptiveSharedMutex Observable<Observer, ObserverTrait<Observer>>::obervers_mu_;
+
+    template<typename Observer>
+    vector<typename Observable<Observer, ObserverTrait<Observer>>::Mutation>
+            Observable<Observer, ObserverTrait<Observer>>::deferred_;
+
+    template<typename Observer>
+    mutex Observable<Observer, ObserverTrait<Observer>>::deferred_mu_;
+
+    template<typename Observer>
+    atomic<bool> Observable<Observer, ObserverTrait<Observer>>::deferred_pending_{false};
+
+    template<typename Observer>
+    thread_local uint32_t Observable<Observer, ObserverTrait<Observer>>::dispatch_depth_ = 0;
 
 
     template<typename Observer>
@@ -111,11 +194,39 @@ namespace observer
                                                         duration<_Rep, _Period> timeout) noexcept
     {
         if (observer.expired()) return AddStatus::InvalidPtr;
-        if (observers_.count(observer.lock()->Hash()) > 0) return AddStatus::AlreadyAdded;
+        if (Registered(observer.lock()->Hash())) return AddStatus::AlreadyAdded;
+        if (Deferred(Mutation{MutationKind::Add, observer.lock()->Hash(), Subscription{observer}})) return AddStatus::Success;
 
-        unique_lock<timed_mutex> lock(obervers_mu_, defer_lock);
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
         if (lock.try_lock_for(timeout))
-            observers_[observer.lock()->Hash()] = observer;
+        {
+            ApplyDeferredExclusive();
+            observers_[observer.lock()->Hash()] = Subscription{observer};
+        }
+        else
+            return AddStatus::Timeout;
+
+        return AddStatus::Success;
+    }
+
+    template<typename Observer>
+    template<typename _Rep, typename _Period>
+    AddStatus
+    Observable<Observer, ObserverTrait<Observer>>::TryAddObserver(typename Observable<Observer, ObserverTrait<Observer>>::ObserverWeak observer,
+                                                        typename Observable<Observer, ObserverTrait<Observer>>::LoopWeak loop,
+                                                        duration<_Rep, _Period> timeout) noexcept
+    {
+        if (observer.expired() || loop.expired()) return AddStatus::InvalidPtr;
+        if (Registered(observer.lock()->Hash())) return AddStatus::AlreadyAdded;
+        if (Deferred(Mutation{MutationKind::Add, observer.lock()->Hash(), Subscription{observer, loop, true}}))
+            return AddStatus::Success;
+
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
+        if (lock.try_lock_for(timeout))
+        {
+            ApplyDeferredExclusive();
+            observers_[observer.lock()->Hash()] = Subscription{observer, loop, true};
+        }
         else
             return AddStatus::Timeout;
 
@@ -130,11 +241,15 @@ namespace observer
                                                             duration<_Rep, _Period> timeout) noexcept
     {
         if (observer.expired()) return RemoveStatus::InvalidPtr;
-        if (observers_.count(observer.lock()->Hash()) == 0) return RemoveStatus::NotFound;
+        if (!Registered(observer.lock()->Hash())) return RemoveStatus::NotFound;
+        if (Deferred(Mutation{MutationKind::Remove, observer.lock()->Hash()})) return RemoveStatus::Success;
 
-        unique_lock<timed_mutex> lock(obervers_mu_, defer_lock);
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
         if (lock.try_lock_for(timeout))
+        {
+            ApplyDeferredExclusive();
             observers_.erase(observer.lock()->Hash());
+        }
         else
             return RemoveStatus::Timeout;
 
@@ -147,11 +262,15 @@ namespace observer
     Observable<Observer, ObserverTrait<Observer>>::TryRemoveObserver(HashType observer_hash,
                                                            duration<_Rep, _Period> timeout) noexcept
     {
-        if (observers_.count(observer_hash) == 0) return RemoveStatus::NotFound;
+        if (!Registered(observer_hash)) return RemoveStatus::NotFound;
+        if (Deferred(Mutation{MutationKind::Remove, observer_hash})) return RemoveStatus::Success;
 
-        unique_lock<timed_mutex> lock(obervers_mu_, defer_lock);
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
         if (lock.try_lock_for(timeout))
+        {
+            ApplyDeferredExclusive();
             observers_.erase(observer_hash);
+        }
         else
             return RemoveStatus::Timeout;
 
@@ -163,9 +282,14 @@ namespace observer
     RemoveStatus
     Observable<Observer, ObserverTrait<Observer>>::TryRemoveAll(duration<_Rep, _Period> timeout) noexcept
     {
-        unique_lock<timed_mutex> lock(obervers_mu_, defer_lock);
+        if (Deferred(Mutation{MutationKind::RemoveAll})) return RemoveStatus::Success;
+
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
         if (lock.try_lock_for(timeout))
+        {
+            ApplyDeferredExclusive();
             observers_.clear();
+        }
         else
             return RemoveStatus::Timeout;
 
@@ -177,9 +301,14 @@ namespace observer
     RemoveStatus
     Observable<Observer, ObserverTrait<Observer>>::TryRemoveExpired(duration<_Rep, _Period> timeout) noexcept
     {
-        unique_lock<timed_mutex> lock(obervers_mu_, defer_lock);
+        if (Deferred(Mutation{MutationKind::RemoveExpired})) return RemoveStatus::Success;
+
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
         if (lock.try_lock_for(timeout))
-            erase_if(observers_, [](const auto& element) { return element.second.expired(); });
+        {
+            ApplyDeferredExclusive();
+            erase_if(observers_, [](const auto& element) { return element.second.observer.expired(); });
+        }
         else
             return RemoveStatus::Timeout;
 
@@ -192,15 +321,15 @@ namespace observer
     Observable<Observer, ObserverTrait<Observer>>::TryNotifyObservers(duration<_Rep, _Period> timeout,
                                                              NotifyArguments&&... args) noexcept
     {
-        unique_lock<timed_mutex> lock(obervers_mu_, defer_lock);
-        if (lock.try_lock_for(timeout))
+        if (dispatch_depth_ > 0) return Fanout(forward<NotifyArguments>(args)...);
+
+        auto deadline = std::chrono::steady_clock::now() + timeout;
         {
-            for (const auto& observer: observers_)
-            {
-                if (!observer.second.expired())
-                    observer.second.lock()->HandleEvent(forward<NotifyArguments>(args)...);
-            }
+            shared_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
+            if (!lock.try_lock_for(timeout)) return;
+            Fanout(forward<NotifyArguments>(args)...);
         }
+        TryApplyDeferred(deadline - std::chrono::steady_clock::now());
     };
 
     template<typename Observer>
@@ -209,11 +338,34 @@ namespace observer
                                                            observer) noexcept
     {
         if (observer.expired()) return AddStatus::InvalidPtr;
-        if (observers_.count(observer.lock()->Hash()) > 0) return AddStatus::AlreadyAdded;
+        if (Registered(observer.lock()->Hash())) return AddStatus::AlreadyAdded;
+        if (Deferred(Mutation{MutationKind::Add, observer.lock()->Hash(), Subscription{observer}})) return AddStatus::Success;
+
+        {
+            lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+            ApplyDeferredExclusive();
+            observers_[observer.lock()->Hash()] = Subscription{observer};
+        }
+
+        return AddStatus::Success;
+    }
+
+    template<typename Observer>
+    AddStatus
+    Observable<Observer, ObserverTrait<Observer>>::AddObserverLocked(typename Observable<Observer, ObserverTrait<Observer>>::ObserverWeak
+                                                           observer,
+                                                           typename Observable<Observer, ObserverTrait<Observer>>::LoopWeak
+                                                           loop) noexcept
+    {
+        if (observer.expired() || loop.expired()) return AddStatus::InvalidPtr;
+        if (Registered(observer.lock()->Hash())) return AddStatus::AlreadyAdded;
+        if (Deferred(Mutation{MutationKind::Add, observer.lock()->Hash(), Subscription{observer, loop, true}}))
+            return AddStatus::Success;
 
         {
-            lock_guard<timed_mutex> lock(obervers_mu_);
-            observers_[observer.lock()->Hash()] = observer;
+            lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+            ApplyDeferredExclusive();
+            observers_[observer.lock()->Hash()] = Subscription{observer, loop, true};
         }
 
         return AddStatus::Success;
@@ -225,10 +377,12 @@ namespace observer
                                                               observer) noexcept
     {
         if (observer.expired()) return RemoveStatus::InvalidPtr;
-        if (observers_.count(observer.lock()->Hash()) == 0) return RemoveStatus::NotFound;
+        if (!Registered(observer.lock()->Hash())) return RemoveStatus::NotFound;
+        if (Deferred(Mutation{MutationKind::Remove, observer.lock()->Hash()})) return RemoveStatus::Success;
 
         {
-            lock_guard<timed_mutex> lock(obervers_mu_);
+            lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+            ApplyDeferredExclusive();
             observers_.erase(observer.lock()->Hash());
         }
 
@@ -239,10 +393,12 @@ namespace observer
     RemoveStatus
     Observable<Observer, ObserverTrait<Observer>>::RemoveObserverLocked(HashType observer_hash) noexcept
     {
-        if (observers_.count(observer_hash) == 0) return RemoveStatus::NotFound;
+        if (!Registered(observer_hash)) return RemoveStatus::NotFound;
+        if (Deferred(Mutation{MutationKind::Remove, observer_hash})) return RemoveStatus::Success;
 
         {
-            lock_guard<timed_mutex> lock(obervers_mu_);
+            lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+            ApplyDeferredExclusive();
             observers_.erase(observer_hash);
         }
 
@@ -253,8 +409,11 @@ namespace observer
     RemoveStatus
     Observable<Observer, ObserverTrait<Observer>>::RemoveAllLocked() noexcept
     {
+        if (Deferred(Mutation{MutationKind::RemoveAll})) return RemoveStatus::Success;
+
         {
-            lock_guard<timed_mutex> lock(obervers_mu_);
+            lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+            ApplyDeferredExclusive();
             observers_.clear();
         }
 
@@ -265,9 +424,12 @@ namespace observer
     RemoveStatus
     Observable<Observer, ObserverTrait<Observer>>::RemoveExpiredLocked() noexcept
     {
+        if (Deferred(Mutation{MutationKind::RemoveExpired})) return RemoveStatus::Success;
+
         {
-            erase_if(observers_, [](const auto& element) { return element.second.expired(); });
-            observers_.clear();
+            lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+            ApplyDeferredExclusive();
+            erase_if(observers_, [](const auto& element) { return element.second.observer.expired(); });
         }
 
         return RemoveStatus::Success;
@@ -278,12 +440,13 @@ namespace observer
     void
     Observable<Observer, ObserverTrait<Observer>>::NotifyObserversLocked(NotifyArguments&&... args) noexcept
     {
-        lock_guard<timed_mutex> lock(obervers_mu_);
-        for (const auto& observer: observers_)
+        if (dispatch_depth_ > 0) return Fanout(forward<NotifyArguments>(args)...);
+
         {
-            if (!observer.second.expired())
-                observer.second.lock()->HandleEvent(forward<NotifyArguments>(args)...);
+            shared_lock<AdaptiveSharedMutex> lock(obervers_mu_);
+            Fanout(forward<NotifyArguments>(args)...);
         }
+        ApplyDeferred();
     }
 
     template<typename Observer>
@@ -293,16 +456,20 @@ namespace observer
     {
         decltype(observers_) observers_copy;
         {
-            lock_guard<timed_mutex> lock(obervers_mu_);
-            observers_copy = observers_;
+            shared_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
+            if (dispatch_depth_ == 0) lock.lock();
+            for (const auto& observer: observers_)
+            {
+                // Loop-bound observers are already asynchronous, so they skip the extra thread
+                if (observer.second.bound) Deliver(observer.second, args...);
+                else observers_copy.insert(observer);
+            }
         }
+        if (observers_copy.empty()) return;
 
         thread{[observers_copy](auto&&... args){
             for (const auto& observer: observers_copy)
-            {
-                if (!observer.second.expired())
-                    observer.second.lock()->HandleEvent(args...);
-            }
+                Deliver(observer.second, args...);
         }, forward<NotifyArguments>(args)...}.detach();
     }
 
@@ -314,16 +481,18 @@ namespace observer
     {
         decltype(observers_) observers_copy;
         {
-            lock_guard<timed_mutex> lock(obervers_mu_);
-            observers_copy = observers_;
+            shared_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
+            if (dispatch_depth_ == 0) lock.lock();
+            for (const auto& observer: observers_)
+            {
+                if (observer.second.bound) Deliver(observer.second, args...);
+                else observers_copy.insert(observer);
+            }
         }
 
         thread{[observers_copy, callback](auto&&... args){
             for (const auto& observer: observers_copy)
-            {
-                if (!observer.second.expired())
-                    observer.second.lock()->HandleEvent(args...);
-            }
+                Deliver(observer.second, args...);
             callback();
         }, forward<NotifyArguments>(args)...}.detach();
     };
@@ -334,6 +503,180 @@ namespace observer
     {
         return observers_.size();
     }
+
+    template<typename Observer>
+    LockStatistics
+    Observable<Observer, ObserverTrait<Observer>>::LockStats() noexcept
+    {
+        return obervers_mu_.Statistics();
+    }
+
+    template<typename Observer>
+    template<typename... NotifyArguments>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::Fanout(NotifyArguments&&... args) noexcept
+    {
+        ++dispatch_depth_;
+        for (const auto& observer: observers_)
+            Deliver(observer.second, forward<NotifyArguments>(args)...);
+        --dispatch_depth_;
+    }
+
+    template<typename Observer>
+    template<typename... NotifyArguments>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::Deliver(const Subscription& subscription,
+                                                           NotifyArguments&&... args) noexcept
+    {
+        if (!subscription.bound)
+        {
+            if (auto observer = subscription.observer.lock())
+                observer->HandleEvent(forward<NotifyArguments>(args)...);
+            return;
+        }
+
+        using Copyable = integral_constant<bool, !is_one_of<false_type,
+                typename integral_constant<bool, is_copy_constructible<decay_t<NotifyArguments>>::value>::type...>::value>;
+        Queue(subscription, Copyable{}, forward<NotifyArguments>(args)...);
+    }
+
+    template<typename Observer>
+    template<typename... NotifyArguments>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::Queue(const Subscription& subscription, true_type,
+                                                         NotifyArguments&&... args) noexcept
+    {
+        // HandleEvent must run on the owning loop's thread; an event for a dead loop is dropped
+        if (auto loop = subscription.loop.lock())
+        {
+            using Arguments = tuple<decay_t<NotifyArguments>...>;
+            loop->Post([observer = subscription.observer, arguments = Arguments(args...)]() mutable {
+                if (auto shared = observer.lock())
+                    HandleQueued(*shared, arguments, index_sequence_for<NotifyArguments...>{});
+            });
+        }
+    }
+
+    template<typename Observer>
+    template<typename... NotifyArguments>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::Queue(const Subscription&, false_type, NotifyArguments&&...) noexcept
+    {
+        // A queued event owns copies of its arguments, so a move-only event never reaches a loop-bound
+        // observer; unbound observers of the same Observable still handle it inline.
+    }
+
+    template<typename Observer>
+    template<typename Arguments, size_t... Indices>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::HandleQueued(Observer& observer, Arguments& arguments,
+                                                                index_sequence<Indices...>) noexcept
+    {
+        observer.HandleEvent(std::get<Indices>(arguments)...);
+    }
+
+    template<typename Observer>
+    bool
+    Observable<Observer, ObserverTrait<Observer>>::Registered(const HashType& hash) noexcept
+    {
+        auto it = observers_.find(hash);
+        bool registered = it != observers_.end();
+        if (!deferred_pending_.load(std::memory_order_acquire)) return registered;
+
+        // Replay the pending log, so Add/Remove issued during a fan-out see each other's effect.
+        ObserverWeak observer = registered ? it->second.observer : ObserverWeak{};
+        lock_guard<mutex> lock(deferred_mu_);
+        for (const auto& mutation: deferred_)
+        {
+            switch (mutation.kind)
+            {
+                case MutationKind::Add:
+                    if (mutation.hash != hash) break;
+                    registered = true;
+                    observer = mutation.subscription.observer;
+                    break;
+                case MutationKind::Remove:
+                    if (mutation.hash == hash) registered = false;
+                    break;
+                case MutationKind::RemoveAll:
+                    registered = false;
+                    break;
+                case MutationKind::RemoveExpired:
+                    registered = registered && !observer.expired();
+                    break;
+            }
+        }
+
+        return registered;
+    }
+
+    template<typename Observer>
+    bool
+    Observable<Observer, ObserverTrait<Observer>>::Deferred(Mutation mutation) noexcept
+    {
+        if (dispatch_depth_ == 0) return false;
+
+        lock_guard<mutex> lock(deferred_mu_);
+        deferred_.push_back(std::move(mutation));
+        deferred_pending_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    template<typename Observer>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::ApplyDeferred() noexcept
+    {
+        if (!deferred_pending_.load(std::memory_order_acquire)) return;
+
+        lock_guard<AdaptiveSharedMutex> lock(obervers_mu_);
+        ApplyDeferredExclusive();
+    }
+
+    template<typename Observer>
+    template<typename _Rep, typename _Period>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::TryApplyDeferred(duration<_Rep, _Period> timeout) noexcept
+    {
+        if (!deferred_pending_.load(std::memory_order_acquire)) return;
+
+        // On timeout the log stays pending and the next notifier applies it.
+        unique_lock<AdaptiveSharedMutex> lock(obervers_mu_, defer_lock);
+        if (lock.try_lock_for(timeout))
+            ApplyDeferredExclusive();
+    }
+
+    template<typename Observer>
+    void
+    Observable<Observer, ObserverTrait<Observer>>::ApplyDeferredExclusive() noexcept
+    {
+        if (!deferred_pending_.load(std::memory_order_acquire)) return;
+
+        vector<Mutation> mutations;
+        {
+            lock_guard<mutex> deferred_lock(deferred_mu_);
+            mutations.swap(deferred_);
+            deferred_pending_.store(false, std::memory_order_relaxed);
+        }
+
+        for (auto& mutation: mutations)
+        {
+            switch (mutation.kind)
+            {
+                case MutationKind::Add:
+                    observers_[mutation.hash] = std::move(mutation.subscription);
+                    break;
+                case MutationKind::Remove:
+                    observers_.erase(mutation.hash);
+                    break;
+                case MutationKind::RemoveAll:
+                    observers_.clear();
+                    break;
+                case MutationKind::RemoveExpired:
+                    erase_if(observers_, [](const auto& element) { return element.second.observer.expired(); });
+                    break;
+            }
+        }
+    }
 }
 
 #endif //MULTITHREADEDOBSERVER_OBSERVABLE_H
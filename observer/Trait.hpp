@@ -1,6 +1,7 @@
 #ifndef MULTITHREADEDOBSERVER_SFINAEOBSERVERTEST_H
 #define MULTITHREADEDOBSERVER_SFINAEOBSERVERTEST_H
 
+#include <utility>
 #include <type_traits>
 
 namespace observer
@@ -8,6 +9,9 @@ namespace observer
     using std::true_type;
     using std::false_type;
     using std::is_same;
+    using std::conditional;
+    using std::declval;
+    using std::enable_if_t;
 
     template<typename T>
     struct is_observer
@@ -22,6 +26,47 @@ namespace observer
         static constexpr bool value = !is_same<false_type, decltype(detect_hash(static_cast<T*>(nullptr)))>::value &&
                                       !is_same<false_type, decltype(detect_handleevet(static_cast<T*>(nullptr)))>::value;
     };
+
+    // Stands in for an Event argument while detecting handlers: it binds only to const Event&, the
+    // way handlers are called, and not to Event&, Event&& or any type Event merely converts to.
+    template<typename Event>
+    struct exact_event
+    {
+        template<typename U, typename = enable_if_t<is_same<U, const Event>::value>>
+        operator U&() const;
+    };
+
+    template<typename T, typename Event>
+    struct handles_event
+    {
+    private:
+        static auto detect_handleevent(...)->false_type;
+        template<typename U> static auto detect_handleevent(U * p) -> decltype(p->HandleEvent(declval<exact_event<Event>>()));
+
+        // Constrained template handlers reject exact_event itself, and a by-value Event parameter cannot
+        // be told apart from Event&& through a conversion, so also look for those exact signatures.
+        static auto detect_signature(...)->false_type;
+        template<typename U> static auto detect_signature(U *)
+            -> decltype(static_cast<void (U::*)(const Event&)>(&U::HandleEvent), true_type{});
+
+        static auto detect_by_value(...)->false_type;
+        template<typename U> static auto detect_by_value(U *)
+            -> decltype(static_cast<void (U::*)(Event)>(&U::HandleEvent), true_type{});
+    public:
+        static constexpr bool value = !is_same<false_type, decltype(detect_handleevent(static_cast<T*>(nullptr)))>::value ||
+                                      !is_same<false_type, decltype(detect_signature(static_cast<T*>(nullptr)))>::value ||
+                                      !is_same<false_type, decltype(detect_by_value(static_cast<T*>(nullptr)))>::value;
+    };
+
+    template<typename T, typename... List>
+    struct is_one_of : false_type
+    {
+    };
+
+    template<typename T, typename Head, typename... Tail>
+    struct is_one_of<T, Head, Tail...> : conditional<is_same<T, Head>::value, true_type, is_one_of<T, Tail...>>::type
+    {
+    };
 }
 
 #endif //MULTITHREADEDOBSERVER_SFINAEOBSERVERTEST_H
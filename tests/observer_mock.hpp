@@ -5,12 +5,20 @@
 #include <chrono>
 #include <tuple>
 #include <string>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <type_traits>
 
 namespace observertest
 {
     using namespace std::chrono;
     using std::tuple;
     using std::string;
+    using std::function;
+    using std::unique_ptr;
+    using std::decay_t;
     using std::default_random_engine;
     using std::uniform_real_distribution;
     using std::uniform_int_distribution;
@@ -96,6 +104,142 @@ namespace observertest
         template<typename func, typename... args>
         void HandleEvent(func, args&&...) {}
     };
+
+
+    struct Observer_6 {
+        void HandleEvent(const int32_t& value)
+        {
+            val = value;
+            ++handled;
+        }
+
+        int32_t val = 0;
+        uint32_t handled = 0;
+    };
+
+
+    struct Observer_9 {
+        void HandleEvent(int32_t&)
+        {
+            ++handled;
+        }
+
+        void HandleEvent(string&&)
+        {
+            ++handled;
+        }
+
+        void HandleEvent(double value)
+        {
+            val = value;
+            ++handled;
+        }
+
+        double val = 0;
+        uint32_t handled = 0;
+    };
+
+
+    struct Observer_7 {
+        Observer_7()
+        {
+            default_random_engine generator(
+                    static_cast<uint64_t>(high_resolution_clock::now().time_since_epoch().count()));
+            uniform_int_distribution<uint64_t> distribution(0, 0xffffffff);
+            hash_ = distribution(generator);
+        }
+
+        uint64_t Hash()
+        {
+            return hash_;
+        }
+
+        template<typename... t>
+        void HandleEvent(t&&...)
+        {
+            ++handled;
+            if (on_event) on_event();
+        }
+
+        function<void()> on_event;
+        uint32_t handled = 0;
+
+    private:
+        uint64_t hash_;
+    };
+
+    struct Observer_8 {
+        Observer_8()
+        {
+            default_random_engine generator(
+                    static_cast<uint64_t>(high_resolution_clock::now().time_since_epoch().count()));
+            uniform_int_distribution<uint64_t> distribution(0, 0xffffffff);
+            hash_ = distribution(generator);
+        }
+
+        uint64_t Hash()
+        {
+            return hash_;
+        }
+
+        void HandleEvent()
+        {
+        }
+
+        void HandleEvent(unique_ptr<int32_t>&& value)
+        {
+            val = *value;
+            ++handled;
+        }
+
+        template<typename Callable, typename Placeholder>
+        void HandleEvent(Callable&& callable, Placeholder&&)
+        {
+            bind_expression = std::is_bind_expression<decay_t<Callable>>::value;
+            placeholder = std::is_placeholder<decay_t<Placeholder>>::value;
+            thread = std::this_thread::get_id();
+            callable();
+            ++handled;
+        }
+
+        int32_t val = 0;
+        bool bind_expression = false;
+        int placeholder = 0;
+        std::thread::id thread;
+        uint32_t handled = 0;
+
+    private:
+        uint64_t hash_;
+    };
+
+    struct Observer_10 {
+        Observer_10()
+        {
+            default_random_engine generator(
+                    static_cast<uint64_t>(high_resolution_clock::now().time_since_epoch().count()));
+            uniform_int_distribution<uint64_t> distribution(0, 0xffffffff);
+            hash_ = distribution(generator);
+        }
+
+        uint64_t Hash()
+        {
+            return hash_;
+        }
+
+        // Concurrent notifications may run this on several threads at once
+        template<typename... t>
+        void HandleEvent(t&&...)
+        {
+            ++handled;
+            if (on_event) on_event();
+        }
+
+        function<void()> on_event;
+        std::atomic<uint32_t> handled{0};
+
+    private:
+        uint64_t hash_;
+    };
 }
 
 #endif //MULTITHREADEDOBSERVER_OBSERVER_MOCK_HPP
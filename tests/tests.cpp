@@ -3,11 +3,19 @@
 #include <chrono>
 #include <memory>
 #include <list>
+#include <atomic>
+#include <thread>
+
+#include <unistd.h>
+#include <sys/epoll.h>
 
 #include <bandit/bandit.h>
 #include "observer_mock.hpp"
 
 #include "../observer/Observable.hpp"
+#include "../observer/EventLoop.hpp"
+#include "../observer/EventObservable.hpp"
+#include "../observer/AdaptiveSharedMutex.hpp"
 
 
 namespace observertest
@@ -262,6 +270,583 @@ namespace observertest
                           std::this_thread::sleep_for(1s);
                       });
                   });
+
+                  describe("EventLoop:", []()
+                  {
+                      using observer::EventLoop;
+
+                      list<shared_ptr<Observer_1>> observers;
+                      for (int i = 0; i < 10; ++i) observers.emplace_back(make_shared<Observer_1>());
+
+                      auto loop = EventLoop::Create();
+
+                      it("AddObserverLocked with loop and Observer_1", [&]()
+                      {
+                          using ObserverWeak = std::weak_ptr<Observer_1>;
+                          Observable<Observer_1>::RemoveAllLocked();
+
+                          for (const auto& element: observers)
+                          {
+                              auto result = Observable<Observer_1>::AddObserverLocked(ObserverWeak{element}, loop);
+                              AssertThat(result, Equals(AddStatus::Success));
+                          }
+                          AssertThat(Observable<Observer_1>::ObserversCount(), Equals(observers.size()));
+
+                          auto result = Observable<Observer_1>::AddObserverLocked(ObserverWeak{make_shared<Observer_1>()},
+                                                                                  std::weak_ptr<EventLoop>{});
+                          AssertThat(result, Equals(AddStatus::InvalidPtr));
+                      });
+
+                      it("NotifyObserversLocked defers HandleEvent to the loop", [&]()
+                      {
+                          Observable<Observer_1>::NotifyObserversLocked("Loop", 7);
+                          for (const auto& observer: observers)
+                              AssertThat(get<1>(observer->val), Equals(0));
+
+                          int epoll_fd = epoll_create1(0);
+                          epoll_event event{};
+                          event.events = EPOLLIN;
+                          epoll_ctl(epoll_fd, EPOLL_CTL_ADD, loop->Fd(), &event);
+
+                          AssertThat(epoll_wait(epoll_fd, &event, 1, 1000), Equals(1));
+                          AssertThat(loop->Dispatch(), Equals(observers.size()));
+                          for (const auto& observer: observers)
+                          {
+                              AssertThat(get<0>(observer->val), Equals("Loop"));
+                              AssertThat(get<1>(observer->val), Equals(7));
+                          }
+                          AssertThat(epoll_wait(epoll_fd, &event, 1, 0), Equals(0));
+                          close(epoll_fd);
+                      });
+
+                      it("Wakeups are coalesced across notifications", [&]()
+                      {
+                          for (const auto& i: {1, 2, 3})
+                              Observable<Observer_1>::AsyncNotifyObservers("Coalesced", i);
+
+                          uint64_t counter = 0;
+                          AssertThat(read(loop->Fd(), &counter, sizeof(counter)), Equals(sizeof(counter)));
+                          AssertThat(counter, Equals(1));
+
+                          AssertThat(loop->Dispatch(), Equals(3 * observers.size()));
+                          for (const auto& observer: observers)
+                              AssertThat(get<1>(observer->val), Equals(3));
+                      });
+
+                      it("Callable events are queued unchanged", [&]()
+                      {
+                          auto callable_observer = make_shared<Observer_8>();
+                          auto result = Observable<Observer_8>::AddObserverLocked(std::weak_ptr<Observer_8>{callable_observer},
+                                                                                  loop);
+                          AssertThat(result, Equals(AddStatus::Success));
+
+                          int calls = 0;
+                          Observable<Observer_8>::NotifyObserversLocked(std::bind([&calls](int value) { calls += value; }, 2),
+                                                                        std::placeholders::_1);
+                          AssertThat(callable_observer->handled, Equals(0));
+
+                          size_t dispatched = 0;
+                          std::thread::id loop_thread;
+                          std::thread{[&]() {
+                              loop_thread = std::this_thread::get_id();
+                              dispatched = loop->Dispatch();
+                          }}.join();
+
+                          AssertThat(dispatched, Equals(1));
+                          AssertThat(calls, Equals(2));
+                          AssertThat(callable_observer->bind_expression, Equals(true));
+                          AssertThat(callable_observer->placeholder, Equals(1));
+                          AssertThat(callable_observer->thread == loop_thread, Equals(true));
+
+                          Observable<Observer_8>::RemoveAllLocked();
+                      });
+
+                      it("Move-only events reach only unbound observers", [&]()
+                      {
+                          auto unbound = make_shared<Observer_8>();
+                          auto bound = make_shared<Observer_8>();
+                          Observable<Observer_8>::AddObserverLocked(std::weak_ptr<Observer_8>{unbound});
+                          Observable<Observer_8>::AddObserverLocked(std::weak_ptr<Observer_8>{bound}, loop);
+                          AssertThat(Observable<Observer_8>::ObserversCount(), Equals(2));
+
+                          Observable<Observer_8>::NotifyObserversLocked(std::unique_ptr<int32_t>(new int32_t(42)));
+                          AssertThat(loop->Dispatch(), Equals(0));
+                          AssertThat(unbound->val, Equals(42));
+                          AssertThat(unbound->handled, Equals(1));
+                          AssertThat(bound->handled, Equals(0));
+
+                          Observable<Observer_8>::RemoveAllLocked();
+                      });
+
+                      it("Events for a destroyed loop are dropped", [&]()
+                      {
+                          loop.reset();
+                          Observable<Observer_1>::NotifyObserversLocked("Dropped", 11);
+                          for (const auto& observer: observers)
+                              AssertThat(get<1>(observer->val), Equals(3));
+
+                          Observable<Observer_1>::RemoveAllLocked();
+                          AssertThat(Observable<Observer_1>::ObserversCount(), Equals(0));
+                      });
+                  });
+
+                  describe("EventObservable:", []()
+                  {
+                      using observer::EventObservable;
+                      using Subject = EventObservable<std::string, int32_t>;
+
+                      auto string_observer = make_shared<Observer_2>();
+                      auto int_observer = make_shared<Observer_4>();
+                      auto any_observer = make_shared<Observer_3>();
+                      auto recording_observer = make_shared<Observer_6>();
+
+                      it("AddObserverLocked registers only into handled event lists", [&]()
+                      {
+                          AssertThat(Subject::AddObserverLocked(weak_ptr<Observer_2>{string_observer}),
+                                     Equals(AddStatus::Success));
+                          AssertThat(Subject::AddObserverLocked(weak_ptr<Observer_4>{int_observer}),
+                                     Equals(AddStatus::Success));
+                          AssertThat(Subject::TryAddObserver(weak_ptr<Observer_3>{any_observer}, 5s),
+                                     Equals(AddStatus::Success));
+                          AssertThat(Subject::AddObserverLocked(weak_ptr<Observer_6>{recording_observer}),
+                                     Equals(AddStatus::Success));
+                          AssertThat(Subject::AddObserverLocked(weak_ptr<Observer_6>{recording_observer}),
+                                     Equals(AddStatus::AlreadyAdded));
+
+                          AssertThat(Subject::ObserversCount<std::string>(), Equals(2));
+                          AssertThat(Subject::ObserversCount<int32_t>(), Equals(3));
+                      });
+
+                      it("NotifyObserversLocked reaches only observers of the event", [&]()
+                      {
+                          Subject::NotifyObserversLocked<int32_t>(42);
+                          AssertThat(recording_observer->val, Equals(42));
+                          AssertThat(recording_observer->handled, Equals(1));
+
+                          Subject::TryNotifyObservers<std::string>(5s, "Hello");
+                          AssertThat(recording_observer->handled, Equals(1));
+                      });
+
+                      it("RemoveObserverLocked drops the observer from every list", [&]()
+                      {
+                          AssertThat(Subject::RemoveObserverLocked(weak_ptr<Observer_3>{any_observer}),
+                                     Equals(RemoveStatus::Success));
+                          AssertThat(Subject::RemoveObserverLocked(weak_ptr<Observer_3>{any_observer}),
+                                     Equals(RemoveStatus::NotFound));
+                          AssertThat(Subject::ObserversCount<std::string>(), Equals(1));
+                          AssertThat(Subject::ObserversCount<int32_t>(), Equals(2));
+                      });
+
+                      it("Convertible event types are not mixed up", [&]()
+                      {
+                          using NumericSubject = EventObservable<int32_t, double>;
+                          auto observer = make_shared<Observer_6>();
+
+                          AssertThat(NumericSubject::AddObserverLocked(weak_ptr<Observer_6>{observer}),
+                                     Equals(AddStatus::Success));
+                          AssertThat(NumericSubject::ObserversCount<int32_t>(), Equals(1));
+                          AssertThat(NumericSubject::ObserversCount<double>(), Equals(0));
+
+                          NumericSubject::NotifyObserversLocked(3.7);
+                          AssertThat(observer->handled, Equals(0));
+                          NumericSubject::NotifyObserversLocked<int32_t>(3);
+                          AssertThat(observer->val, Equals(3));
+
+                          NumericSubject::RemoveAllLocked();
+                      });
+
+                      it("Handlers taking a mutable or rvalue reference are not registered", [&]()
+                      {
+                          using MixedSubject = EventObservable<int32_t, std::string, double>;
+                          auto observer = make_shared<Observer_9>();
+
+                          static_assert(!observer::handles_event<Observer_9, int32_t>::value, "int32_t& is not const");
+                          static_assert(!observer::handles_event<Observer_9, std::string>::value, "string&& is not const");
+                          static_assert(observer::handles_event<Observer_9, double>::value, "double is taken by value");
+
+                          AssertThat(MixedSubject::AddObserverLocked(weak_ptr<Observer_9>{observer}),
+                                     Equals(AddStatus::Success));
+                          AssertThat(MixedSubject::ObserversCount<int32_t>(), Equals(0));
+                          AssertThat(MixedSubject::ObserversCount<std::string>(), Equals(0));
+                          AssertThat(MixedSubject::ObserversCount<double>(), Equals(1));
+
+                          MixedSubject::NotifyObserversLocked(2.5);
+                          AssertThat(observer->val, Equals(2.5));
+                          AssertThat(observer->handled, Equals(1));
+
+                          MixedSubject::RemoveAllLocked();
+                      });
+
+                      it("RemoveExpiredLocked and RemoveAllLocked", [&]()
+                      {
+                          int_observer.reset();
+                          AssertThat(Subject::RemoveExpiredLocked(), Equals(RemoveStatus::Success));
+                          AssertThat(Subject::ObserversCount<int32_t>(), Equals(1));
+
+                          AssertThat(Subject::RemoveAllLocked(), Equals(RemoveStatus::Success));
+                          AssertThat(Subject::ObserversCount<std::string>(), Equals(0));
+                          AssertThat(Subject::ObserversCount<int32_t>(), Equals(0));
+                      });
+                  });
+
+                  describe("Deferred mutations:", []()
+                  {
+                      using ObserverWeak = std::weak_ptr<Observer_7>;
+
+                      list<shared_ptr<Observer_7>> observers;
+                      for (int i = 0; i < 10; ++i) observers.emplace_back(make_shared<Observer_7>());
+
+                      it("RemoveObserverLocked from HandleEvent makes one-shot observers", [&]()
+                      {
+                          list<RemoveStatus> results;
+                          for (const auto& element: observers)
+                          {
+                              auto hash = element->Hash();
+                              element->on_event = [hash, &results]() {
+                                  results.push_back(Observable<Observer_7>::RemoveObserverLocked(hash));
+                              };
+                              auto result = Observable<Observer_7>::AddObserverLocked(ObserverWeak{element});
+                              AssertThat(result, Equals(AddStatus::Success));
+                          }
+
+                          Observable<Observer_7>::NotifyObserversLocked();
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(0));
+
+                          Observable<Observer_7>::TryNotifyObservers(5s);
+                          for (const auto& observer: observers)
+                          {
+                              AssertThat(observer->handled, Equals(1));
+                              observer->on_event = nullptr;
+                          }
+                          AssertThat(results.size(), Equals(observers.size()));
+                          for (const auto& result: results)
+                              AssertThat(result, Equals(RemoveStatus::Success));
+                      });
+
+                      it("AddObserverLocked from HandleEvent applies after the fan-out", [&]()
+                      {
+                          auto first = observers.front();
+                          auto second = observers.back();
+                          AddStatus result = AddStatus::Timeout;
+                          first->on_event = [second, &result]() {
+                              result = Observable<Observer_7>::AddObserverLocked(ObserverWeak{second});
+                          };
+                          Observable<Observer_7>::AddObserverLocked(ObserverWeak{first});
+
+                          Observable<Observer_7>::TryNotifyObservers(5s);
+                          first->on_event = nullptr;
+                          AssertThat(result, Equals(AddStatus::Success));
+                          AssertThat(first->handled, Equals(2));
+                          AssertThat(second->handled, Equals(1));
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(2));
+                      });
+
+                      it("Remove then add within one fan-out keeps the observer", [&]()
+                      {
+                          auto first = observers.front();
+                          auto second = observers.back();
+                          RemoveStatus removed = RemoveStatus::Timeout;
+                          AddStatus added = AddStatus::Timeout;
+                          AddStatus added_again = AddStatus::Timeout;
+                          bool done = false;
+                          first->on_event = [&]() {
+                              if (done) return;
+                              done = true;
+                              removed = Observable<Observer_7>::RemoveObserverLocked(ObserverWeak{second});
+                              added = Observable<Observer_7>::AddObserverLocked(ObserverWeak{second});
+                              added_again = Observable<Observer_7>::AddObserverLocked(ObserverWeak{second});
+                          };
+
+                          Observable<Observer_7>::NotifyObserversLocked();
+                          first->on_event = nullptr;
+                          AssertThat(removed, Equals(RemoveStatus::Success));
+                          AssertThat(added, Equals(AddStatus::Success));
+                          AssertThat(added_again, Equals(AddStatus::AlreadyAdded));
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(2));
+                      });
+
+                      it("Add then remove within one fan-out drops the observer", [&]()
+                      {
+                          auto first = observers.front();
+                          auto third = *std::next(observers.begin());
+                          AddStatus added = AddStatus::Timeout;
+                          AddStatus added_again = AddStatus::Timeout;
+                          RemoveStatus removed = RemoveStatus::Timeout;
+                          RemoveStatus removed_again = RemoveStatus::Timeout;
+                          bool done = false;
+                          first->on_event = [&]() {
+                              if (done) return;
+                              done = true;
+                              added = Observable<Observer_7>::AddObserverLocked(ObserverWeak{third});
+                              added_again = Observable<Observer_7>::AddObserverLocked(ObserverWeak{third});
+                              removed = Observable<Observer_7>::RemoveObserverLocked(ObserverWeak{third});
+                              removed_again = Observable<Observer_7>::RemoveObserverLocked(third->Hash());
+                          };
+
+                          Observable<Observer_7>::NotifyObserversLocked();
+                          first->on_event = nullptr;
+                          AssertThat(added, Equals(AddStatus::Success));
+                          AssertThat(added_again, Equals(AddStatus::AlreadyAdded));
+                          AssertThat(removed, Equals(RemoveStatus::Success));
+                          AssertThat(removed_again, Equals(RemoveStatus::NotFound));
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(2));
+                      });
+
+                      it("Nested notifications and RemoveAllLocked from HandleEvent", [&]()
+                      {
+                          auto first = observers.front();
+                          auto handled = first->handled;
+                          bool nested = false;
+                          first->on_event = [&nested]() {
+                              if (nested) return;
+                              nested = true;
+                              Observable<Observer_7>::NotifyObserversLocked();
+                              Observable<Observer_7>::RemoveAllLocked();
+                          };
+
+                          Observable<Observer_7>::NotifyObserversLocked();
+                          first->on_event = nullptr;
+                          AssertThat(first->handled, Equals(handled + 2));
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(0));
+                      });
+
+                      it("RemoveExpiredLocked keeps live observers", [&]()
+                      {
+                          for (const auto& element: observers)
+                              Observable<Observer_7>::AddObserverLocked(ObserverWeak{element});
+                          for (int i = 0; i < 3; ++i)
+                              Observable<Observer_7>::AddObserverLocked(ObserverWeak{make_shared<Observer_7>()});
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(observers.size() + 3));
+
+                          AssertThat(Observable<Observer_7>::RemoveExpiredLocked(), Equals(RemoveStatus::Success));
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(observers.size()));
+                          Observable<Observer_7>::RemoveAllLocked();
+                      });
+
+                      it("A pending log is applied before a later direct change", [&]()
+                      {
+                          // Copying an argument for a loop-bound observer happens under the shared lock,
+                          // so this holds it without applying the log afterwards, the way a notifier
+                          // whose apply timed out does.
+                          struct BlockingCopy
+                          {
+                              BlockingCopy(std::atomic<bool>& copying, std::atomic<bool>& released)
+                                      : copying(&copying), released(&released)
+                              {
+                              }
+
+                              BlockingCopy(const BlockingCopy& other)
+                                      : copying(other.copying), released(other.released)
+                              {
+                                  copying->store(true);
+                                  while (!released->load()) std::this_thread::yield();
+                              }
+
+                              std::atomic<bool>* copying;
+                              std::atomic<bool>* released;
+                          };
+
+                          auto loop = observer::EventLoop::Create();
+                          auto remover = observers.front();
+                          auto removed = observers.back();
+                          auto bound = make_shared<Observer_7>();
+                          std::atomic<bool> armed{false};
+                          list<RemoveStatus> results;
+                          remover->on_event = [&armed, &results, removed]() {
+                              if (armed) results.push_back(Observable<Observer_7>::RemoveObserverLocked(removed->Hash()));
+                          };
+                          Observable<Observer_7>::AddObserverLocked(ObserverWeak{remover});
+                          Observable<Observer_7>::AddObserverLocked(ObserverWeak{removed});
+                          Observable<Observer_7>::AddObserverLocked(ObserverWeak{bound}, loop);
+
+                          std::atomic<bool> copying{false};
+                          std::atomic<bool> released{false};
+                          std::atomic<bool> delivered{false};
+                          std::thread holder{[&]() {
+                              Observable<Observer_7>::AsyncNotifyObserversCallback([&delivered]() { delivered = true; },
+                                                                                   BlockingCopy{copying, released});
+                          }};
+                          while (!copying) std::this_thread::yield();
+
+                          // The Remove is logged, and applying it times out behind the holder.
+                          armed = true;
+                          Observable<Observer_7>::TryNotifyObservers(20ms);
+                          armed = false;
+                          released = true;
+                          holder.join();
+                          while (!delivered) std::this_thread::yield();
+
+                          AssertThat(Observable<Observer_7>::AddObserverLocked(ObserverWeak{removed}),
+                                     Equals(AddStatus::Success));
+                          Observable<Observer_7>::NotifyObserversLocked();
+                          remover->on_event = nullptr;
+                          loop->Dispatch();
+
+                          AssertThat(results, Equals(list<RemoveStatus>{RemoveStatus::Success}));
+                          AssertThat(Observable<Observer_7>::ObserversCount(), Equals(3));
+                          Observable<Observer_7>::RemoveAllLocked();
+                      });
+                  });
+
+                  describe("AdaptiveSharedMutex:", []()
+                  {
+                      using observer::AdaptiveSharedMutex;
+
+                      it("Shared owners exclude exclusive ones", [&]()
+                      {
+                          AdaptiveSharedMutex mu;
+                          mu.lock_shared();
+                          AssertThat(mu.try_lock_shared(), Equals(true));
+                          AssertThat(mu.try_lock_for(10ms), Equals(false));
+
+                          mu.unlock_shared();
+                          mu.unlock_shared();
+                          AssertThat(mu.try_lock_for(10ms), Equals(true));
+                          mu.unlock();
+                      });
+
+                      it("Exclusive owner parks and then wakes shared waiters", [&]()
+                      {
+                          AdaptiveSharedMutex mu;
+                          std::atomic<bool> timed_out{false};
+                          std::atomic<bool> attempted{false};
+                          std::atomic<bool> acquired{false};
+                          mu.lock();
+
+                          std::thread reader{[&]() {
+                              timed_out = !mu.try_lock_shared_for(10ms);
+                              attempted = true;
+                              mu.lock_shared();
+                              acquired = true;
+                              mu.unlock_shared();
+                          }};
+                          while (!attempted) std::this_thread::yield();
+                          std::this_thread::sleep_for(20ms);
+                          AssertThat(acquired.load(), Equals(false));
+
+                          mu.unlock();
+                          reader.join();
+                          AssertThat(timed_out.load(), Equals(true));
+                          AssertThat(acquired.load(), Equals(true));
+
+                          auto stats = mu.Statistics();
+                          AssertThat(stats.timeouts, Equals(1));
+                          AssertThat(stats.contended_acquisitions >= 1, Equals(true));
+                          AssertThat(stats.parked_acquisitions >= 1, Equals(true));
+                      });
+
+                      it("Try* calls time out behind a running notification", [&]()
+                      {
+                          auto slow = make_shared<Observer_7>();
+                          slow->on_event = []() { std::this_thread::sleep_for(100ms); };
+                          Observable<Observer_7>::AddObserverLocked(std::weak_ptr<Observer_7>{slow});
+                          auto timeouts = Observable<Observer_7>::LockStats().timeouts;
+
+                          std::thread notifier{[]() { Observable<Observer_7>::NotifyObserversLocked(); }};
+                          std::this_thread::sleep_for(20ms);
+                          auto result = Observable<Observer_7>::TryAddObserver(std::weak_ptr<Observer_7>{make_shared<Observer_7>()},
+                                                                               10ms);
+                          notifier.join();
+
+                          AssertThat(result, Equals(AddStatus::Timeout));
+                          AssertThat(Observable<Observer_7>::LockStats().timeouts, Equals(timeouts + 1));
+                          Observable<Observer_7>::RemoveAllLocked();
+                      });
+
+                      it("Concurrent notifications run HandleEvent at the same time", [&]()
+                      {
+                          auto shared_observer = make_shared<Observer_10>();
+                          std::atomic<int32_t> inside{0};
+                          std::atomic<bool> overlapped{true};
+                          shared_observer->on_event = [&inside, &overlapped]() {
+                              ++inside;
+                              auto deadline = steady_clock::now() + 5s;
+                              while (inside < 2 && steady_clock::now() < deadline) std::this_thread::yield();
+                              if (inside < 2) overlapped = false;
+                          };
+                          Observable<Observer_10>::AddObserverLocked(std::weak_ptr<Observer_10>{shared_observer});
+
+                          std::thread first{[]() { Observable<Observer_10>::NotifyObserversLocked(); }};
+                          std::thread second{[]() { Observable<Observer_10>::NotifyObserversLocked(); }};
+                          first.join();
+                          second.join();
+                          shared_observer->on_event = nullptr;
+
+                          AssertThat(overlapped.load(), Equals(true));
+                          AssertThat(shared_observer->handled.load(), Equals(2));
+                          Observable<Observer_10>::RemoveAllLocked();
+                      });
+
+                      it("Deferred mutations of concurrent notifications are all applied", [&]()
+                      {
+                          using ObserverWeak = std::weak_ptr<Observer_10>;
+                          auto dispatcher = make_shared<Observer_10>();
+                          auto removed = make_shared<Observer_10>();
+                          auto first_added = make_shared<Observer_10>();
+                          auto second_added = make_shared<Observer_10>();
+
+                          std::atomic<int32_t> inside{0};
+                          std::atomic<int32_t> succeeded{0};
+                          std::atomic<bool> overlapped{true};
+                          dispatcher->on_event = [&]() {
+                              int32_t order = inside++;
+                              auto deadline = steady_clock::now() + 5s;
+                              while (inside < 2 && steady_clock::now() < deadline) std::this_thread::yield();
+                              if (inside < 2) overlapped = false;
+
+                              if (order == 0)
+                              {
+                                  succeeded += Observable<Observer_10>::AddObserverLocked(ObserverWeak{first_added}) ==
+                                               AddStatus::Success;
+                                  succeeded += Observable<Observer_10>::RemoveObserverLocked(removed->Hash()) ==
+                                               RemoveStatus::Success;
+                              }
+                              else
+                              {
+                                  succeeded += Observable<Observer_10>::AddObserverLocked(ObserverWeak{second_added}) ==
+                                               AddStatus::Success;
+                              }
+                          };
+                          Observable<Observer_10>::AddObserverLocked(ObserverWeak{dispatcher});
+                          Observable<Observer_10>::AddObserverLocked(ObserverWeak{removed});
+
+                          std::thread first{[]() { Observable<Observer_10>::NotifyObserversLocked(); }};
+                          std::thread second{[]() { Observable<Observer_10>::NotifyObserversLocked(); }};
+                          first.join();
+                          second.join();
+                          dispatcher->on_event = nullptr;
+
+                          AssertThat(overlapped.load(), Equals(true));
+                          AssertThat(succeeded.load(), Equals(3));
+                          AssertThat(Observable<Observer_10>::ObserversCount(), Equals(3));
+                          AssertThat(Observable<Observer_10>::RemoveObserverLocked(removed->Hash()),
+                                     Equals(RemoveStatus::NotFound));
+                          AssertThat(Observable<Observer_10>::RemoveObserverLocked(first_added->Hash()),
+                                     Equals(RemoveStatus::Success));
+                          AssertThat(Observable<Observer_10>::RemoveObserverLocked(second_added->Hash()),
+                                     Equals(RemoveStatus::Success));
+                          Observable<Observer_10>::RemoveAllLocked();
+                      });
+
+#ifdef MULTITHREADEDOBSERVER_LOCK_STATISTICS
+                      it("Uncontended acquisitions and exclusive holds are counted", [&]()
+                      {
+                          AdaptiveSharedMutex mu;
+                          mu.lock_shared();
+                          mu.unlock_shared();
+                          mu.lock();
+                          std::this_thread::sleep_for(1ms);
+                          mu.unlock();
+
+                          auto stats = mu.Statistics();
+                          AssertThat(stats.shared_acquisitions, Equals(1));
+                          AssertThat(stats.exclusive_acquisitions, Equals(1));
+                          AssertThat(stats.contended_acquisitions, Equals(0));
+                          AssertThat(stats.exclusive_hold_ns >= 1000000, Equals(true));
+                          AssertThat(stats.max_exclusive_hold_ns, Equals(stats.exclusive_hold_ns));
+                      });
+#endif
+                  });
               });
 }
 